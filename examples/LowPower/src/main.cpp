@@ -0,0 +1,48 @@
+/**
+ * ESP32-RTTL_Player low-power playback example
+ *
+ * Light sleeps between note boundaries while LEDC keeps the tone going, then
+ * prints how much of the playback time was spent asleep.
+ *
+ * Needs -DRTTTL_ENABLE_POWER_SAVE=1 (see platformio.ini). USB CDC serial drops
+ * out while the chip sleeps, so the report is printed after each tune ends.
+ */
+#include <Arduino.h>
+#include <RTTTLPlayer.h>
+#include <RTTTLTunes.h>
+
+// Pin assignment for audio output
+#define PIN_AUDIO_OUT 3
+// Volume  0 - 255
+#define AUDIO_VOLUME 180
+
+RTTTLPlayer player(PIN_AUDIO_OUT, AUDIO_VOLUME);
+
+void setup() {
+    Serial.begin(115200);
+    player.begin();
+    player.setDebug(false);  // Serial output would keep waking the chip
+    delay(2000);
+    
+    Serial.println("\n🎵 RTTTL Player Low Power Test");
+    Serial.println("==============================");
+}
+
+void loop() {
+    Serial.println("* Playing Imperial March with light sleep...");
+    Serial.flush();
+    
+    player.resetPowerStats();
+    player.play(RTTTLTunes::imperial);
+    while (player.isPlaying()) {
+        player.loop();
+        player.sleepUntilNextNote();
+    }
+    
+    uint32_t asleep = player.getSleepTimeMs();
+    uint32_t awake = player.getAwakeTimeMs();
+    Serial.printf("  asleep: %lums  awake: %lums  (%lu%% asleep)\n",
+                  (unsigned long)asleep, (unsigned long)awake,
+                  (unsigned long)(asleep * 100 / (asleep + awake + 1)));
+    delay(3000);
+}
@@ -0,0 +1,81 @@
+/**
+ * ESP32-RTTL_Player playlist example
+ *
+ * Plays a shuffled playlist on repeat. The next track is staged while the
+ * current one plays, so tracks follow each other without a gap.
+ *
+ * Serial commands: 'p' play from the start, 'n' next track,
+ *                  's' toggle shuffle, 'r' cycle repeat mode
+ */
+#include <Arduino.h>
+#include <RTTTLPlayer.h>
+#include <RTTTLPlaylist.h>
+#include <RTTTLTunes.h>
+
+// Pin assignment for audio output
+#define PIN_AUDIO_OUT 3
+// Volume  0 - 255
+#define AUDIO_VOLUME 180
+
+RTTTLPlayer player(PIN_AUDIO_OUT, AUDIO_VOLUME);
+RTTTLPlaylist playlist(player);
+
+const char* const REPEAT_NAMES[] = { "off", "one", "all" };
+
+void setup() {
+    Serial.begin(115200);
+    player.begin();
+    player.setDebug(false);
+    randomSeed(esp_random());
+    
+    playlist.add(RTTTLTunes::nokia);
+    playlist.add(RTTTLTunes::tetris);
+    playlist.add(RTTTLTunes::mario);
+    playlist.add(RTTTLTunes::pinkPanther);
+    playlist.add(RTTTLTunes::zelda);
+    
+    playlist.setShuffle(true);
+    playlist.setRepeat(RTTTLPlaylist::REPEAT_ALL);
+    playlist.play();
+    
+    Serial.println("\n🎵 RTTTL Player Playlist Test");
+    Serial.println("=============================");
+    Serial.println("p = play, n = next, s = shuffle, r = repeat mode");
+}
+
+void loop() {
+    static int lastTrack = -1;
+    
+    // Use playlist.loop() instead of player.loop()
+    playlist.loop();
+    
+    if (playlist.getCurrentTrack() != lastTrack) {
+        lastTrack = playlist.getCurrentTrack();
+        if (lastTrack >= 0) {
+            Serial.printf("* Track %d\n", lastTrack);
+        } else {
+            Serial.println("End of playlist");
+        }
+    }
+    
+    if (Serial.available()) {
+        switch (Serial.read()) {
+            case 'p':
+                playlist.play();
+                break;
+            case 'n':
+                playlist.next();
+                break;
+            case 's':
+                playlist.setShuffle(!playlist.getShuffle());
+                Serial.printf("Shuffle %s\n", playlist.getShuffle() ? "on" : "off");
+                break;
+            case 'r':
+                playlist.setRepeat(static_cast<RTTTLPlaylist::RepeatMode>((playlist.getRepeat() + 1) % 3));
+                Serial.printf("Repeat %s\n", REPEAT_NAMES[playlist.getRepeat()]);
+                break;
+        }
+    }
+    
+    delay(1);
+}
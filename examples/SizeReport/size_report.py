@@ -0,0 +1,35 @@
+# PlatformIO extra script: adds a "size_report" target that prints the
+# flash and RAM usage of the firmware for the current environment.
+import re
+import subprocess
+
+Import("env")
+
+# Same section patterns PlatformIO uses for its own "Checking size" summary
+FLASH_RE = env.get("SIZEPROGREGEXP") or \
+    r"^(?:\.iram0\.text|\.iram0\.vectors|\.dram0\.data|\.flash\.text|\.flash\.rodata|\.flash\.appdesc|)\s+(\d+).*"
+RAM_RE = env.get("SIZEDATAREGEXP") or \
+    r"^(?:\.dram0\.data|\.dram0\.bss|\.noinit)\s+(\d+).*"
+
+
+def section_total(output, pattern):
+    return sum(int(m.group(1)) for m in re.finditer(pattern, output, re.M))
+
+
+def size_report(target, source, env):
+    elf = str(source[0])
+    output = subprocess.check_output(
+        [env.subst("$SIZETOOL"), "-A", "-d", elf]).decode()
+    print("[size_report] %-12s flash: %7d bytes  ram: %6d bytes" % (
+        env["PIOENV"],
+        section_total(output, FLASH_RE),
+        section_total(output, RAM_RE)))
+
+
+env.AddCustomTarget(
+    name="size_report",
+    dependencies="$BUILD_DIR/${PROGNAME}.elf",
+    actions=[size_report],
+    title="Size Report",
+    description="Print flash/RAM usage for this configuration",
+    always_build=True)
@@ -0,0 +1,38 @@
+/**
+ * ESP32-RTTL_Player footprint example
+ *
+ * Plays three alert beeps using only the core API so it builds under every
+ * configuration in platformio.ini. Run "pio run -t size_report" to compare.
+ */
+#include <Arduino.h>
+#include <RTTTLPlayer.h>
+
+// Pin assignment for audio output
+#define PIN_AUDIO_OUT 3
+// Volume  0 - 255
+#define AUDIO_VOLUME 180
+
+const char beepShort[] = "Short:d=16,o=6,b=200:c7";
+const char beepDouble[] = "Double:d=16,o=6,b=200:c7,p,c7";
+const char beepAlarm[] = "Alarm:d=8,o=6,b=200:a,p,a,p,a";
+
+RTTTLPlayer player(PIN_AUDIO_OUT, AUDIO_VOLUME);
+
+void setup() {
+    player.begin();
+    player.play(beepShort);
+}
+
+void loop() {
+    static uint8_t next = 1;
+
+    player.loop();
+    if (!player.isPlaying()) {
+        delay(1000);
+        switch (next++ % 3) {
+            case 0: player.play(beepShort); break;
+            case 1: player.play(beepDouble); break;
+            case 2: player.play(beepAlarm); break;
+        }
+    }
+}
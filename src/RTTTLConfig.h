@@ -0,0 +1,59 @@
+#ifndef RTTTLCONFIG_H
+#define RTTTLCONFIG_H
+
+/**
+ * @file RTTTLConfig.h
+ * @brief Compile-time feature selection shared by the player and parser
+ */
+
+// ============================================================================
+// COMPILE-TIME FEATURE SELECTION
+// ============================================================================
+// Define any of these as 0 in build_flags (e.g. -DRTTTL_ENABLE_DEBUG=0) to
+// strip the feature. Disabled features compile out completely: no code and
+// no state members. The DEBUG, LOOPING, TEMPO and FREQUENCY methods remain as
+// inline no-ops so sketches written against the full API still build.
+
+#ifndef RTTTL_ENABLE_DEBUG
+#define RTTTL_ENABLE_DEBUG 1      ///< Serial debug output and setDebug()
+#endif
+
+#ifndef RTTTL_ENABLE_LOOPING
+#define RTTTL_ENABLE_LOOPING 1    ///< loopCount argument of play()
+#endif
+
+#ifndef RTTTL_ENABLE_TEMPO
+#define RTTTL_ENABLE_TEMPO 1      ///< setTempoScale() and float tempo math
+#endif
+
+#ifndef RTTTL_ENABLE_FREQUENCY
+#define RTTTL_ENABLE_FREQUENCY 1  ///< getCurrentFrequency() for EQ meters
+#endif
+
+// queueNext(), hasQueued(), clearQueue() and the whole RTTTLPlaylist class
+// are removed when this is 0, not stubbed.
+#ifndef RTTTL_ENABLE_QUEUE
+#define RTTTL_ENABLE_QUEUE 1      ///< queueNext() gapless track staging, RTTTLPlaylist
+#endif
+
+// Opt-in: sleepUntilNextNote() and the sleep/awake counters only exist
+// when this is 1. They are not stubbed, so a sketch that relies on them
+// fails to build instead of silently never sleeping.
+#ifndef RTTTL_ENABLE_POWER_SAVE
+#define RTTTL_ENABLE_POWER_SAVE 0 ///< Light sleep between notes (opt-in)
+#endif
+
+#ifndef RTTTL_MIN_SLEEP_MS
+#define RTTTL_MIN_SLEEP_MS 3      ///< Shorter gaps are not worth a sleep/wake cycle
+#endif
+
+// With neither tempo scaling nor the frequency getter there is nothing left
+// that needs fractional Hz, so the note table and tone calls use integers and
+// no soft-float code is linked (the ESP32-C3 has no FPU).
+#if !RTTTL_ENABLE_TEMPO && !RTTTL_ENABLE_FREQUENCY
+#define RTTTL_INTEGER_FREQUENCY 1
+#else
+#define RTTTL_INTEGER_FREQUENCY 0
+#endif
+
+#endif // RTTTLCONFIG_H
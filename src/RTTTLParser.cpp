@@ -0,0 +1,193 @@
+#include "RTTTLParser.h"
+#include <stddef.h>
+
+// ============================================================================
+// NOTE FREQUENCY TABLE (FLASH MEMORY)
+// ============================================================================
+
+#if RTTTL_INTEGER_FREQUENCY
+const RTTTLFrequency RTTTLParser::NOTE_FREQUENCIES[RTTTLParser::NOTE_COUNT] = {
+    // Octave 0
+    16, 17, 18, 19, 21, 22, 23, 25, 26, 28, 29, 31,
+    // Octave 1
+    33, 35, 37, 39, 41, 44, 46, 49, 52, 55, 58, 62,
+    // Octave 2
+    65, 69, 73, 78, 82, 87, 93, 98, 104, 110, 117, 123,
+    // Octave 3
+    131, 139, 147, 156, 165, 175, 185, 196, 208, 220, 233, 247,
+    // Octave 4 (A4 = 440Hz is at index 57)
+    262, 277, 294, 311, 330, 349, 370, 392, 415, 440, 466, 494,
+    // Octave 5
+    523, 554, 587, 622, 659, 698, 740, 784, 831, 880, 932, 988,
+    // Octave 6
+    1047, 1109, 1175, 1245, 1319, 1397, 1480, 1568, 1661, 1760, 1865, 1976,
+    // Octave 7
+    2093, 2217, 2349, 2489, 2637, 2794, 2960, 3136, 3322, 3520, 3729, 3951,
+    // Octave 8
+    4186, 4435, 4699, 4978, 5274, 5588, 5920, 6272, 6645, 7040, 7459, 7902
+};
+#else
+const RTTTLFrequency RTTTLParser::NOTE_FREQUENCIES[RTTTLParser::NOTE_COUNT] = {
+    // Octave 0
+    16.35, 17.32, 18.35, 19.45, 20.60, 21.83, 23.12, 24.50, 25.96, 27.50, 29.14, 30.87,
+    // Octave 1
+    32.70, 34.65, 36.71, 38.89, 41.20, 43.65, 46.25, 49.00, 51.91, 55.00, 58.27, 61.74,
+    // Octave 2
+    65.41, 69.30, 73.42, 77.78, 82.41, 87.31, 92.50, 98.00, 103.83, 110.00, 116.54, 123.47,
+    // Octave 3
+    130.81, 138.59, 146.83, 155.56, 164.81, 174.61, 185.00, 196.00, 207.65, 220.00, 233.08, 246.94,
+    // Octave 4 (A4 = 440Hz is at index 57)
+    261.63, 277.18, 293.66, 311.13, 329.63, 349.23, 369.99, 392.00, 415.30, 440.00, 466.16, 493.88,
+    // Octave 5
+    523.25, 554.37, 587.33, 622.25, 659.25, 698.46, 739.99, 783.99, 830.61, 880.00, 932.33, 987.77,
+    // Octave 6
+    1046.50, 1108.73, 1174.66, 1244.51, 1318.51, 1396.91, 1479.98, 1567.98, 1661.22, 1760.00, 1864.66, 1975.53,
+    // Octave 7
+    2093.00, 2217.46, 2349.32, 2489.02, 2637.02, 2793.83, 2959.96, 3135.96, 3322.44, 3520.00, 3729.31, 3951.07,
+    // Octave 8
+    4186.01, 4434.92, 4698.63, 4978.03, 5274.04, 5587.65, 5919.91, 6271.93, 6644.88, 7040.00, 7458.62, 7902.13
+};
+#endif
+
+// ============================================================================
+// CONSTRUCTOR
+// ============================================================================
+
+RTTTLParser::RTTTLParser()
+    : _tune(NULL), _tunePtr(NULL), _bpm(63),
+      _defaultDuration(4), _defaultOctave(6) {
+}
+
+// ============================================================================
+// PUBLIC METHODS
+// ============================================================================
+
+bool RTTTLParser::begin(const char* rtttl) {
+    _tune = rtttl;
+    _tunePtr = rtttl;
+    _bpm = 63;
+    _defaultDuration = 4;
+    _defaultOctave = 6;
+    
+    if (!_tunePtr) return false;
+    
+    // Skip to the notes section
+    while (*_tunePtr && *_tunePtr != ':') _tunePtr++;
+    if (!*_tunePtr) return false;
+    _tunePtr++;
+    
+    // Parse default settings
+    while (*_tunePtr && *_tunePtr != ':') {
+        if (*_tunePtr == 'd' && *(_tunePtr+1) == '=') {
+            _tunePtr += 2;
+            _defaultDuration = parseNumber(_tunePtr);
+        }
+        else if (*_tunePtr == 'o' && *(_tunePtr+1) == '=') {
+            _tunePtr += 2;
+            _defaultOctave = parseNumber(_tunePtr);
+        }
+        else if (*_tunePtr == 'b' && *(_tunePtr+1) == '=') {
+            _tunePtr += 2;
+            _bpm = parseNumber(_tunePtr);
+        }
+        else {
+            _tunePtr++;  // Skip spaces and unknown keys
+        }
+        if (*_tunePtr == ',') _tunePtr++;
+    }
+    
+    if (!*_tunePtr) return false;
+    _tunePtr++;
+    
+    return true;
+}
+
+bool RTTTLParser::next(RTTTLNote& note) {
+    if (!_tunePtr) return false;
+    
+    // Skip spaces and commas
+    while (*_tunePtr == ' ' || *_tunePtr == ',') _tunePtr++;
+    if (!*_tunePtr) return false;
+    
+    // Parse one note
+    int duration = _defaultDuration;
+    int noteValue = -1;
+    int octave = _defaultOctave;
+    int dots = 0;
+    
+    if (*_tunePtr >= '0' && *_tunePtr <= '9') {
+        duration = parseNumber(_tunePtr);
+    }
+    
+    char noteChar = *_tunePtr;
+    switch (noteChar) {
+        case 'c': case 'C': noteValue = 0; break;
+        case 'd': case 'D': noteValue = 2; break;
+        case 'e': case 'E': noteValue = 4; break;
+        case 'f': case 'F': noteValue = 5; break;
+        case 'g': case 'G': noteValue = 7; break;
+        case 'a': case 'A': noteValue = 9; break;
+        case 'b': case 'B': noteValue = 11; break;
+        case 'p': case 'P': noteValue = -1; break;
+    }
+    
+    if (*_tunePtr) _tunePtr++;
+    
+    if (noteValue >= 0) {
+        if (*_tunePtr == '#') {
+            noteValue++;
+            _tunePtr++;
+        }
+        // Dots may come before the octave ("8c.6") as well as after it
+        while (*_tunePtr == '.') {
+            dots++;
+            _tunePtr++;
+        }
+        if (*_tunePtr >= '0' && *_tunePtr <= '9') {
+            octave = *_tunePtr - '0';
+            _tunePtr++;
+        }
+    }
+    
+    while (*_tunePtr == '.') {
+        dots++;
+        _tunePtr++;
+    }
+    
+    note.index = (noteValue >= 0) ? octave * 12 + noteValue : -1;
+    note.durationMs = calculateDuration(duration, dots, _bpm);
+    return true;
+}
+
+RTTTLFrequency RTTTLParser::getFrequency(int index) {
+    if (index >= 0 && index < NOTE_COUNT) {
+        return NOTE_FREQUENCIES[index];
+    }
+    return 0;
+}
+
+int RTTTLParser::calculateDuration(int duration, int dots, int bpm) {
+    if (duration <= 0 || bpm <= 0) return 0;
+    
+    int baseMs = (60000 / bpm) * 4 / duration;
+    int total = baseMs;
+    int add = baseMs / 2;
+    for (int i = 0; i < dots; i++) {
+        total += add;
+        add /= 2;
+    }
+    return total;
+}
+
+// ============================================================================
+// PRIVATE HELPER METHODS
+// ============================================================================
+
+int RTTTLParser::parseNumber(const char* &ptr) {
+    int num = 0;
+    while (*ptr >= '0' && *ptr <= '9') {
+        if (num < 10000) num = num * 10 + (*ptr - '0');  // Saturate garbage input
+        ptr++;
+    }
+    return num;
+}
@@ -0,0 +1,90 @@
+#ifndef RTTTLPARSER_H
+#define RTTTLPARSER_H
+
+#include <stdint.h>
+#include "RTTTLConfig.h"
+
+/**
+ * @file RTTTLParser.h
+ * @brief Hardware-independent RTTTL parser
+ *
+ * Shared by RTTTLPlayer on the device and by the host tools, so both read a
+ * tune exactly the same way. No Arduino dependencies.
+ */
+
+/// @brief Note frequency in Hz (whole Hz in integer-only builds)
+#if RTTTL_INTEGER_FREQUENCY
+typedef uint16_t RTTTLFrequency;
+#else
+typedef float RTTTLFrequency;
+#endif
+
+/// @brief One parsed note or rest
+struct RTTTLNote {
+    int index;          ///< Note table index (octave * 12 + semitone), -1 for a rest
+    int durationMs;     ///< Duration at the tune's own BPM (no tempo scaling)
+};
+
+class RTTTLParser {
+public:
+    /// @brief Number of entries in the note frequency table (C0 to B8)
+    static const int NOTE_COUNT = 108;
+
+    /// @brief Note frequency table (C0 to B8) - stored in flash
+    static const RTTTLFrequency NOTE_FREQUENCIES[NOTE_COUNT];
+
+    RTTTLParser();
+
+    /**
+     * @brief Parse the RTTTL header and position at the first note
+     * @param rtttl RTTTL format string (must stay valid while parsing)
+     * @return true if the header was valid
+     */
+    bool begin(const char* rtttl);
+
+    /**
+     * @brief Parse the next note
+     * @param note Receives the parsed note
+     * @return false once the end of the tune is reached
+     */
+    bool next(RTTTLNote& note);
+
+    /**
+     * @brief Get the tune passed to begin()
+     * @return RTTTL string, or NULL if none
+     */
+    const char* getTune() const { return _tune; }
+
+    /**
+     * @brief Get BPM from the tune header
+     * @return Beats per minute (63 if the header has no b= value)
+     */
+    int getBpm() const { return _bpm; }
+
+    /**
+     * @brief Look up the frequency of a note table index
+     * @param index Note table index from RTTTLNote
+     * @return Frequency in Hz, or 0 for rests and notes outside the table
+     */
+    static RTTTLFrequency getFrequency(int index);
+
+    /**
+     * @brief Calculate the length of a note in milliseconds
+     * @param duration Note duration (1=whole, 4=quarter, ...)
+     * @param dots Number of dots after the note
+     * @param bpm Beats per minute
+     * @return Duration in milliseconds, 0 if duration or bpm is invalid
+     */
+    static int calculateDuration(int duration, int dots, int bpm);
+
+private:
+    static int parseNumber(const char* &ptr);
+
+    const char* _tune;          ///< Start of current RTTTL string
+    const char* _tunePtr;       ///< Current position in RTTTL string
+    int _bpm;                   ///< BPM from header
+    int _defaultDuration;       ///< d= value from header
+    int _defaultOctave;         ///< o= value from header
+};
+
+#endif // RTTTLPARSER_H
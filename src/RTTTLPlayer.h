@@ -2,6 +2,8 @@
 #define RTTTLPLAYER_H
 
 #include <Arduino.h>
+#include "RTTTLConfig.h"
+#include "RTTTLParser.h"
 
 class RTTTLPlayer {
 public:
@@ -32,14 +34,73 @@ public:
     
     /**
      * @brief Stop playback immediately
+     * @note Also drops any tune staged with queueNext()
      */
     void stop();
     
+#if RTTTL_ENABLE_QUEUE
+    /**
+     * @brief Stage the tune to play when the current one ends
+     * @param rtttl RTTTL format string (must stay valid until it has played)
+     * @return true if the tune was staged, or started because the player was idle.
+     *         false for an invalid header, leaving any staged tune in place.
+     * @note The header is parsed now, so the first note starts in the same
+     *       loop() tick that the previous tune's last note ends. Like play(),
+     *       the switch resets the tempo scale to 1.0.
+     */
+    bool queueNext(const char* rtttl);
+    
+    /**
+     * @brief Check if a tune is staged
+     * @return true until the staged tune starts playing
+     */
+    bool hasQueued() const { return _hasQueued; }
+    
+    /**
+     * @brief Drop the staged tune, if any
+     */
+    void clearQueue() { _hasQueued = false; }
+#endif
+    
     /**
      * @brief Update player state - call this in your main loop()
      */
     void loop();
     
+    /**
+     * @brief Get the next note boundary
+     * @return millis() value when the current note ends
+     * @note Lets the app sleep or schedule other work until then
+     */
+    unsigned long getNextDeadline() const { return _noteEndTime; }
+    
+#if RTTTL_ENABLE_POWER_SAVE
+    /**
+     * @brief Light sleep until the current note ends
+     * @param maxSleepMs Upper bound on the sleep (0 = no limit)
+     * @return true if the CPU slept
+     * @note LEDC keeps generating the tone while asleep. Call right after loop().
+     */
+    bool sleepUntilNextNote(uint32_t maxSleepMs = 0);
+    
+    /**
+     * @brief Get time spent in light sleep during playback
+     * @return Milliseconds asleep since the last resetPowerStats()
+     */
+    uint32_t getSleepTimeMs() const { return static_cast<uint32_t>(_sleepUs / 1000); }
+    
+    /**
+     * @brief Get time spent awake during playback
+     * @return Milliseconds of playback not spent asleep since the last resetPowerStats()
+     */
+    uint32_t getAwakeTimeMs() const;
+    
+    /**
+     * @brief Clear the sleep/awake counters
+     */
+    void resetPowerStats();
+#endif
+    
     /**
      * @brief Check if player is currently playing
      * @return true if audio is playing
@@ -50,13 +111,21 @@ public:
      * @brief Check if player is in loop mode
      * @return true if looping enabled
      */
+#if RTTTL_ENABLE_LOOPING
     bool isLooping() const { return _loopCount > 0; }
+#else
+    bool isLooping() const { return false; }
+#endif
     
     /**
      * @brief Get remaining loop count
      * @return 0=not looping, 1-254=loops remaining, 255=infinite loop
      */
+#if RTTTL_ENABLE_LOOPING
     uint8_t getRemainingLoops() const { return _loopCount; }
+#else
+    uint8_t getRemainingLoops() const { return 0; }
+#endif
     
     /**
      * @brief Set playback volume
@@ -75,43 +144,57 @@ public:
      * @param scale 0.5 = half speed, 1.0 = normal, 2.0 = double speed
      * @note Takes effect on next note
      */
+#if RTTTL_ENABLE_TEMPO
     void setTempoScale(float scale);
+#else
+    void setTempoScale(float) {}
+#endif
     
     /**
      * @brief Get current tempo scaling
      * @return Current tempo multiplier
      */
+#if RTTTL_ENABLE_TEMPO
     float getTempoScale() const { return _tempoScale; }
+#else
+    float getTempoScale() const { return 1.0f; }
+#endif
     
     /**
      * @brief Get current frequency being played
      * @return Frequency in Hz, or 0 if no note is playing (rest/pause)
      * @note Useful for EQ meters and visualizers
      */
+#if RTTTL_ENABLE_FREQUENCY
     float getCurrentFrequency() const { return _currentFrequency; }
+#else
+    float getCurrentFrequency() const { return 0.0f; }
+#endif
     
     /**
      * @brief Get current BPM including tempo scaling
      * @return Effective BPM (original BPM × tempo scale)
      */
-    int getCurrentBPM() const { return static_cast<int>(_currentBpm * _tempoScale + 0.5f); }
+#if RTTTL_ENABLE_TEMPO
+    int getCurrentBPM() const { return static_cast<int>(_parser.getBpm() * _tempoScale + 0.5f); }
+#else
+    int getCurrentBPM() const { return _parser.getBpm(); }
+#endif
     
     /**
      * @brief Enable/disable debug serial output
      * @param enabled true to enable debug messages
      */
+#if RTTTL_ENABLE_DEBUG
     void setDebug(bool enabled) { _debug = enabled; }
+#else
+    void setDebug(bool) {}
+#endif
     
 private:
     enum PlayerState { STATE_IDLE, STATE_PLAYING, STATE_PAUSED };
     
-    /// @brief Note frequency table (C0 to B8) - stored in flash
-    static const float NOTE_FREQUENCIES[108];
-    
     // Helper functions
-    int parseNumber(const char* &ptr);
-    int calculateDuration(int duration, int dots, int bpm);
-    float getFrequency(uint8_t note, uint8_t octave);
     void parseNextNote();
     
     // Hardware properties
@@ -120,18 +203,37 @@ private:
     
     // Player state
     PlayerState _state;         ///< Current playback state
+#if RTTTL_ENABLE_DEBUG
     bool _debug;                ///< Debug output enabled
+#endif
+#if RTTTL_ENABLE_LOOPING
     uint8_t _loopCount;         ///< Remaining loop count
+#endif
     
     // Playback tracking
-    const char* _currentTune;   ///< Pointer to current RTTTL string
-    const char* _tunePtr;       ///< Current position in RTTTL string
+    RTTTLParser _parser;        ///< Parser positioned in current RTTTL string
     unsigned long _noteEndTime; ///< When current note ends (millis)
+#if RTTTL_ENABLE_QUEUE
+    RTTTLParser _queuedParser;  ///< Header-parsed tune to play next
+    bool _hasQueued;            ///< _queuedParser holds a staged tune
+#endif
     
     // Frequency and tempo tracking
+#if RTTTL_ENABLE_FREQUENCY
     volatile float _currentFrequency; ///< Frequency of currently playing note
-    volatile int _currentBpm;         ///< BPM from current RTTTL
+#else
+    bool _toneOn;                     ///< A note (not a rest) is sounding
+#endif
+#if RTTTL_ENABLE_TEMPO
     volatile float _tempoScale;       ///< Tempo multiplier (default 1.0)
+#endif
+    
+    // Power statistics (esp_timer microseconds)
+#if RTTTL_ENABLE_POWER_SAVE
+    int64_t _playStartUs;       ///< When current playback started, 0 if idle
+    int64_t _playUs;            ///< Completed playback time
+    int64_t _sleepUs;           ///< Time spent in light sleep
+#endif
 };
 
 #endif // RTTTLPLAYER_H
\ No newline at end of file
@@ -0,0 +1,203 @@
+#include "RTTTLPlaylist.h"
+
+#if RTTTL_ENABLE_QUEUE
+
+// ============================================================================
+// CONSTRUCTOR
+// ============================================================================
+
+RTTTLPlaylist::RTTTLPlaylist(RTTTLPlayer& player)
+    : _player(player), _count(0), _pos(0), _current(-1), _stagedPos(0),
+      _stagedTrack(-1), _stagedWrap(false), _shuffle(false), _repeat(REPEAT_OFF) {
+}
+
+// ============================================================================
+// PUBLIC METHODS
+// ============================================================================
+
+bool RTTTLPlaylist::add(const char* rtttl) {
+    if (_count >= RTTTL_PLAYLIST_MAX_TRACKS) return false;
+    
+    _tracks[_count] = rtttl;
+    _order[_count] = _count;
+    _count++;
+    
+    // Appending while the pass is ending: the new track comes next
+    if (_current >= 0 && (_stagedTrack < 0 || _stagedWrap)) restage();
+    return true;
+}
+
+void RTTTLPlaylist::clear() {
+    stop();
+    _count = 0;
+}
+
+bool RTTTLPlaylist::play() {
+    stop();
+    newPass(-1);
+    
+    // Skip tracks with an invalid header
+    for (int pos = 0; pos < _count; pos++) {
+        if (startAt(pos)) return true;
+    }
+    return false;
+}
+
+bool RTTTLPlaylist::next() {
+    if (_current < 0) return false;
+    
+    // Manual skip always moves on, even in REPEAT_ONE
+    _player.stop();
+    _stagedTrack = -1;
+    for (int pos = _pos + 1; pos < _count; pos++) {
+        if (startAt(pos)) return true;
+    }
+    if (_repeat != REPEAT_OFF) {
+        newPass(-1);
+        for (int pos = 0; pos < _count; pos++) {
+            if (startAt(pos)) return true;
+        }
+    }
+    
+    _current = -1;
+    return false;
+}
+
+void RTTTLPlaylist::stop() {
+    _player.stop();
+    _current = -1;
+    _stagedTrack = -1;
+}
+
+void RTTTLPlaylist::loop() {
+    _player.loop();
+    if (_current < 0) return;
+    
+    if (!_player.isPlaying()) {
+        // Last track ended with nothing staged
+        _current = -1;
+        _stagedTrack = -1;
+        return;
+    }
+    
+    // The player switched to the staged track: stage the one after it
+    if (_stagedTrack >= 0 && !_player.hasQueued()) {
+        if (_stagedWrap) {
+            // Only now is the next pass reached
+            newPass(_stagedTrack);
+        } else {
+            _pos = _stagedPos;
+        }
+        _current = _stagedTrack;
+        _stagedTrack = -1;
+        stageNext();
+    }
+}
+
+void RTTTLPlaylist::setShuffle(bool enabled) {
+    _shuffle = enabled;
+    
+    // A staged pass opener was picked under the old setting
+    if (_current >= 0 && _stagedWrap) restage();
+}
+
+void RTTTLPlaylist::setRepeat(RepeatMode mode) {
+    _repeat = mode;
+    
+    // Restage so the new mode applies to the very next track
+    if (_current >= 0) restage();
+}
+
+// ============================================================================
+// PRIVATE HELPER METHODS
+// ============================================================================
+
+void RTTTLPlaylist::newPass(int first) {
+    for (uint8_t i = 0; i < _count; i++) _order[i] = i;
+    _pos = 0;
+    
+    if (_shuffle && _count > 1) {
+        // Fisher-Yates
+        for (int i = _count - 1; i > 0; i--) {
+            int j = random(i + 1);
+            uint8_t tmp = _order[i];
+            _order[i] = _order[j];
+            _order[j] = tmp;
+        }
+        if (first >= 0) {
+            // Open with the track already staged for this pass
+            for (int i = 0; i < _count; i++) {
+                if (_order[i] == first) {
+                    _order[i] = _order[0];
+                    _order[0] = first;
+                    break;
+                }
+            }
+        } else if (_order[0] == _current) {
+            // Don't open with the track that was just playing
+            int j = 1 + random(_count - 1);
+            _order[0] = _order[j];
+            _order[j] = _current;
+        }
+    } else if (first >= 0) {
+        _pos = first;  // Sequential: earlier tracks were skipped as invalid
+    }
+}
+
+bool RTTTLPlaylist::startAt(int pos) {
+    if (!_player.play(_tracks[_order[pos]])) return false;
+    
+    _pos = pos;
+    _current = _order[pos];
+    stageNext();
+    return true;
+}
+
+bool RTTTLPlaylist::stageNext() {
+    _stagedTrack = -1;
+    _stagedWrap = false;
+    
+    if (_repeat == REPEAT_ONE) {
+        if (!_player.queueNext(_tracks[_current])) return false;
+        _stagedPos = _pos;
+        _stagedTrack = _current;
+        return true;
+    }
+    
+    // Rest of the current pass
+    for (int pos = _pos + 1; pos < _count; pos++) {
+        if (_player.queueNext(_tracks[_order[pos]])) {
+            _stagedPos = pos;
+            _stagedTrack = _order[pos];
+            return true;
+        }
+    }
+    if (_repeat != REPEAT_ALL) return false;
+    
+    // Pick only the opener of the next pass; its order is built when it starts
+    int start = (_shuffle && _count > 1) ? random(_count) : 0;
+    for (int i = 0; i < _count; i++) {
+        int track = (start + i) % _count;
+        if (_shuffle && _count > 1 && track == _current) continue;
+        if (_player.queueNext(_tracks[track])) {
+            _stagedTrack = track;
+            _stagedWrap = true;
+            return true;
+        }
+    }
+    
+    // Only the current track is playable
+    if (_player.queueNext(_tracks[_current])) {
+        _stagedTrack = _current;
+        _stagedWrap = true;
+        return true;
+    }
+    return false;
+}
+
+void RTTTLPlaylist::restage() {
+    _player.clearQueue();
+    stageNext();
+}
+
+#endif // RTTTL_ENABLE_QUEUE
@@ -0,0 +1,130 @@
+#ifndef RTTTLPLAYLIST_H
+#define RTTTLPLAYLIST_H
+
+#include "RTTTLPlayer.h"
+
+#if RTTTL_ENABLE_QUEUE
+
+#ifndef RTTTL_PLAYLIST_MAX_TRACKS
+#define RTTTL_PLAYLIST_MAX_TRACKS 16  ///< Playlist capacity (no heap allocation)
+#endif
+
+/**
+ * @brief Track queue with shuffle/repeat on top of RTTTLPlayer
+ *
+ * The next track is always staged in the player with queueNext(), so it
+ * starts in the same tick the current one ends. Call loop() instead of
+ * player.loop() while the playlist is in use.
+ */
+class RTTTLPlaylist {
+public:
+    enum RepeatMode { REPEAT_OFF, REPEAT_ONE, REPEAT_ALL };
+    
+    /**
+     * @brief Construct a playlist driving an existing player
+     * @param player Player to play tracks on (must be begin()'d)
+     */
+    RTTTLPlaylist(RTTTLPlayer& player);
+    
+    /**
+     * @brief Append a track
+     * @param rtttl RTTTL format string (must stay valid while in the playlist)
+     * @return false if the playlist is full
+     */
+    bool add(const char* rtttl);
+    
+    /**
+     * @brief Stop playback and remove all tracks
+     */
+    void clear();
+    
+    /**
+     * @brief Get number of tracks
+     * @return Track count
+     */
+    uint8_t size() const { return _count; }
+    
+    /**
+     * @brief Start playing from the first track (a random one when shuffling)
+     * @return true if a track started
+     */
+    bool play();
+    
+    /**
+     * @brief Skip to the next track immediately
+     * @return true if a track started, false at the end of the playlist
+     */
+    bool next();
+    
+    /**
+     * @brief Stop playback
+     */
+    void stop();
+    
+    /**
+     * @brief Update playback and stage the next track - call this in your main loop()
+     */
+    void loop();
+    
+    /**
+     * @brief Check if the playlist is playing
+     * @return true while any track is playing
+     */
+    bool isPlaying() const { return _current >= 0; }
+    
+    /**
+     * @brief Get the track being played
+     * @return Index as passed to add() order, or -1 when stopped
+     */
+    int getCurrentTrack() const { return _current; }
+    
+    /**
+     * @brief Enable/disable shuffle
+     * @param enabled true to play tracks in random order
+     * @note Takes effect on the next play() or pass through the playlist
+     */
+    void setShuffle(bool enabled);
+    
+    /**
+     * @brief Check if shuffle is enabled
+     * @return true if shuffling
+     */
+    bool getShuffle() const { return _shuffle; }
+    
+    /**
+     * @brief Set repeat mode
+     * @param mode REPEAT_OFF, REPEAT_ONE (current track) or REPEAT_ALL (whole playlist)
+     */
+    void setRepeat(RepeatMode mode);
+    
+    /**
+     * @brief Get repeat mode
+     * @return Current repeat mode
+     */
+    RepeatMode getRepeat() const { return _repeat; }
+    
+private:
+    void newPass(int first);
+    bool startAt(int pos);
+    bool stageNext();
+    void restage();
+    
+    RTTTLPlayer& _player;
+    
+    const char* _tracks[RTTTL_PLAYLIST_MAX_TRACKS]; ///< Tunes in add() order
+    uint8_t _order[RTTTL_PLAYLIST_MAX_TRACKS];      ///< Play order (shuffled or sequential)
+    uint8_t _count;             ///< Number of tracks
+    
+    int _pos;                   ///< Position of current track in _order
+    int _current;               ///< Current track index, -1 when stopped
+    int _stagedPos;             ///< Position of the staged track in _order
+    int _stagedTrack;           ///< Track staged in the player, -1 if none
+    bool _stagedWrap;           ///< Staged track opens the next pass (_order not built yet)
+    
+    bool _shuffle;              ///< Shuffle enabled
+    RepeatMode _repeat;         ///< Repeat mode
+};
+
+#endif // RTTTL_ENABLE_QUEUE
+
+#endif // RTTTLPLAYLIST_H
@@ -0,0 +1,236 @@
+/**
+ * RTTTL corpus analyzer (host tool)
+ *
+ * Parses whole RTTTL tune banks in parallel with the same RTTTLParser the
+ * device uses, and prints one CSV row per tune plus a summary on stderr.
+ *
+ * Accepts plain one-tune-per-line files and the christmas_songs.txt format
+ * (a quoted, comma separated list with '#' comments).
+ *
+ * Usage: rtttl_analyzer [-j threads] [-q] file...
+ */
+#include <RTTTLParser.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @brief Analysis result for one tune
+struct TuneStats {
+    const char* tune;       ///< NUL-terminated RTTTL string
+    bool valid;             ///< Header parsed successfully
+    int bpm;                ///< BPM the player will use
+    long durationMs;        ///< Total playing time
+    int notes;              ///< Pitched notes
+    int rests;              ///< Pauses
+    int lowest;             ///< Lowest note table index, -1 if none
+    int highest;            ///< Highest note table index, -1 if none
+    int outOfRange;         ///< Notes outside the 108-entry table (played silent)
+    size_t flashBytes;      ///< Size as a const char[] in RTTTLTunes.h
+};
+
+static const char* const NOTE_NAMES[12] = {
+    "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"
+};
+
+static void analyzeTune(TuneStats& stats) {
+    RTTTLParser parser;
+    RTTTLNote note;
+    
+    stats.valid = parser.begin(stats.tune);
+    stats.bpm = parser.getBpm();
+    stats.durationMs = 0;
+    stats.notes = 0;
+    stats.rests = 0;
+    stats.lowest = -1;
+    stats.highest = -1;
+    stats.outOfRange = 0;
+    stats.flashBytes = strlen(stats.tune) + 1;
+    if (!stats.valid) return;
+    
+    while (parser.next(note)) {
+        stats.durationMs += note.durationMs;
+        if (note.index < 0) {
+            stats.rests++;
+            continue;
+        }
+        stats.notes++;
+        if (note.index >= RTTTLParser::NOTE_COUNT) stats.outOfRange++;
+        if (stats.lowest < 0 || note.index < stats.lowest) stats.lowest = note.index;
+        if (note.index > stats.highest) stats.highest = note.index;
+    }
+}
+
+// ============================================================================
+// CORPUS LOADING
+// ============================================================================
+
+static bool readFile(const char* path, std::string& data) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    char buf[1 << 16];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) data.append(buf, n);
+    fclose(f);
+    return true;
+}
+
+/**
+ * Split a corpus buffer into tunes in place. Each tune is NUL-terminated
+ * inside the buffer, so the buffer must outlive the returned pointers.
+ */
+static void splitTunes(std::string& data, std::vector<TuneStats>& tunes) {
+    char* p = &data[0];
+    char* end = p + data.size();
+    
+    while (p < end) {
+        char* line = p;
+        char* eol = static_cast<char*>(memchr(p, '\n', end - p));
+        if (!eol) eol = end;
+        p = eol + 1;
+        
+        // Trim whitespace, then the list syntax of christmas_songs.txt
+        char* last = eol;
+        while (line < last && (*line == ' ' || *line == '\t')) line++;
+        while (last > line && (last[-1] == '\r' || last[-1] == ' ' || last[-1] == '\t')) last--;
+        if (line == last || *line == '#') continue;
+        if (last > line && last[-1] == ',') last--;
+        if (last - line >= 2 && (*line == '\'' || *line == '"') && last[-1] == *line) {
+            line++;
+            last--;
+        }
+        if (!memchr(line, ':', last - line)) continue;  // "SONGS = [", "]", ...
+        
+        *last = '\0';
+        TuneStats stats;
+        stats.tune = line;
+        tunes.push_back(stats);
+    }
+}
+
+// ============================================================================
+// OUTPUT
+// ============================================================================
+
+static void printNote(FILE* out, int index) {
+    if (index < 0) return;
+    fprintf(out, "%s%d%s", NOTE_NAMES[index % 12], index / 12,
+            index >= RTTTLParser::NOTE_COUNT ? "!" : "");
+}
+
+static void printName(FILE* out, const char* tune) {
+    fputc('"', out);
+    for (const char* p = tune; *p && *p != ':'; p++) {
+        if (*p == '"') fputc('"', out);
+        fputc(*p, out);
+    }
+    fputc('"', out);
+}
+
+static void usage() {
+    fprintf(stderr,
+            "Usage: rtttl_analyzer [-j threads] [-q] file...\n"
+            "  -j N  worker threads (default: all cores, max 4x cores)\n"
+            "  -q    summary only, no per-tune CSV\n");
+}
+
+int main(int argc, char** argv) {
+    unsigned cores = std::thread::hardware_concurrency();
+    if (cores == 0) cores = 1;
+    const long maxThreads = static_cast<long>(cores) * 4;
+    
+    unsigned threads = cores;
+    bool quiet = false;
+    std::vector<const char*> paths;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            char* end;
+            long n = strtol(argv[++i], &end, 10);
+            if (*argv[i] == '\0' || *end != '\0' || n <= 0) {
+                fprintf(stderr, "rtttl_analyzer: invalid thread count '%s'\n", argv[i]);
+                return 2;
+            }
+            threads = static_cast<unsigned>(n > maxThreads ? maxThreads : n);
+        } else if (strcmp(argv[i], "-q") == 0) {
+            quiet = true;
+        } else if (argv[i][0] == '-') {
+            usage();
+            return 2;
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    if (paths.empty()) {
+        usage();
+        return 2;
+    }
+    auto start = std::chrono::steady_clock::now();
+    
+    // Buffers are kept alive for the whole run; tunes point into them
+    std::vector<std::string> buffers(paths.size());
+    std::vector<TuneStats> tunes;
+    for (size_t i = 0; i < paths.size(); i++) {
+        if (!readFile(paths[i], buffers[i])) {
+            fprintf(stderr, "rtttl_analyzer: cannot read %s\n", paths[i]);
+            return 1;
+        }
+        splitTunes(buffers[i], tunes);
+    }
+    
+    // Workers claim fixed-size chunks so short and long tunes balance out
+    const size_t CHUNK = 256;
+    std::atomic<size_t> nextIndex(0);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&]() {
+            for (;;) {
+                size_t first = nextIndex.fetch_add(CHUNK);
+                if (first >= tunes.size()) break;
+                size_t last = first + CHUNK < tunes.size() ? first + CHUNK : tunes.size();
+                for (size_t i = first; i < last; i++) analyzeTune(tunes[i]);
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    
+    // Per-tune CSV
+    static char outBuf[1 << 16];
+    setvbuf(stdout, outBuf, _IOFBF, sizeof(outBuf));
+    if (!quiet) {
+        printf("name,valid,bpm,duration_ms,notes,rests,lowest,highest,out_of_range,flash_bytes\n");
+    }
+    
+    size_t invalid = 0, flagged = 0, flashTotal = 0;
+    long long durationTotal = 0, notesTotal = 0;
+    for (const TuneStats& s : tunes) {
+        if (!s.valid) invalid++;
+        if (s.outOfRange) flagged++;
+        flashTotal += s.flashBytes;
+        durationTotal += s.durationMs;
+        notesTotal += s.notes + s.rests;
+        if (quiet) continue;
+        
+        printName(stdout, s.tune);
+        printf(",%d,%d,%ld,%d,%d,", s.valid ? 1 : 0, s.bpm, s.durationMs, s.notes, s.rests);
+        printNote(stdout, s.lowest);
+        fputc(',', stdout);
+        printNote(stdout, s.highest);
+        printf(",%d,%zu\n", s.outOfRange, s.flashBytes);
+    }
+    fflush(stdout);
+    
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    fprintf(stderr,
+            "%zu tunes, %lld notes, %.1f min total, %zu bytes flash\n"
+            "%zu invalid headers, %zu tunes with notes outside the table (marked '!')\n"
+            "%.3f s on %u threads\n",
+            tunes.size(), notesTotal, durationTotal / 60000.0, flashTotal,
+            invalid, flagged, elapsed, threads);
+    return 0;
+}
@@ -0,0 +1,30 @@
+#ifndef ARDUINO_STUB_H
+#define ARDUINO_STUB_H
+
+/**
+ * @file Arduino.h
+ * @brief Minimal host stand-in for the Arduino core used by RTTTLPlayer
+ *
+ * Time is simulated and LEDC calls are recorded by the test, see
+ * test_playlist.cpp for the definitions.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+unsigned long millis();
+long random(long max);
+
+void ledcAttach(uint8_t pin, uint32_t freq, uint8_t resolution);
+void ledcWrite(uint8_t pin, uint32_t duty);
+void ledcWriteTone(uint8_t pin, uint32_t freq);
+
+struct HardwareSerialStub {
+    void print(const char*) {}
+    void println(const char*) {}
+    int printf(const char*, ...) { return 0; }
+};
+extern HardwareSerialStub Serial;
+
+#endif // ARDUINO_STUB_H
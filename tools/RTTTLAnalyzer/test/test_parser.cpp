@@ -0,0 +1,105 @@
+/**
+ * Host tests for RTTTLParser
+ *
+ * Pins down exactly how tunes are read, since the device player and the
+ * analyzer share this parser. Run with "make test".
+ */
+#include <RTTTLParser.h>
+
+#include <cstdio>
+#include <cstring>
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+/// @brief Parse a whole tune, returns note count or -1 on a bad header
+static int parseAll(const char* rtttl, RTTTLNote* notes, int maxNotes) {
+    RTTTLParser parser;
+    if (!parser.begin(rtttl)) return -1;
+    int count = 0;
+    RTTTLNote note;
+    while (parser.next(note)) {
+        if (count < maxNotes) notes[count] = note;
+        count++;
+    }
+    return count;
+}
+
+static void testHeaderDefaults() {
+    RTTTLNote n[4];
+    // d= and o= apply to notes without their own duration/octave
+    CHECK(parseAll("T:d=8,o=4,b=120:c,d5,4e", n, 4) == 3);
+    CHECK(n[0].index == 48 && n[0].durationMs == 250);
+    CHECK(n[1].index == 62 && n[1].durationMs == 250);
+    CHECK(n[2].index == 52 && n[2].durationMs == 500);
+    
+    // Empty header: d=4, o=6, b=63
+    RTTTLParser parser;
+    CHECK(parser.begin("T::c"));
+    CHECK(parser.getBpm() == 63);
+    CHECK(parser.next(n[0]));
+    CHECK(n[0].index == 72 && n[0].durationMs == 952);
+}
+
+static void testNoteSyntax() {
+    RTTTLNote n[4];
+    // Sharps, rests, and dots before or after the octave
+    CHECK(parseAll("T:d=4,o=5,b=120:c#,8p,8c.6,8c6.", n, 4) == 4);
+    CHECK(n[0].index == 61 && n[0].durationMs == 500);
+    CHECK(n[1].index == -1 && n[1].durationMs == 250);
+    CHECK(n[2].index == 72 && n[2].durationMs == 375);
+    CHECK(n[3].index == 72 && n[3].durationMs == 375);
+    
+    // Separators and trailing spaces do not produce notes
+    CHECK(parseAll("T:d=4,o=5,b=120: c , ,d,, ", n, 4) == 2);
+}
+
+static void testMalformedInput() {
+    RTTTLNote n[4];
+    // Trailing duration with no note becomes a rest and stops at the end
+    CHECK(parseAll("T:d=4,o=5,b=120:c,8", n, 4) == 2);
+    CHECK(n[1].index == -1 && n[1].durationMs == 250);
+    
+    // d=0 and b=0 give zero-length notes instead of dividing by zero
+    CHECK(parseAll("T:d=0,o=5,b=120:c", n, 4) == 1);
+    CHECK(n[0].durationMs == 0);
+    CHECK(parseAll("T:d=4,o=5,b=0:c", n, 4) == 1);
+    CHECK(n[0].durationMs == 0);
+    
+    // Unknown keys and spaces in the header are skipped
+    CHECK(parseAll("T:d=4, x=9,o=5 ,b=120:c", n, 4) == 1);
+    CHECK(n[0].index == 60 && n[0].durationMs == 500);
+    
+    // Missing sections
+    CHECK(parseAll("no colon", n, 4) == -1);
+    CHECK(parseAll("T:d=4,o=5,b=120", n, 4) == -1);
+    CHECK(parseAll("T:d=4,o=5,b=120:", n, 4) == 0);
+}
+
+static void testFrequencies() {
+    CHECK(RTTTLParser::getFrequency(57) == 440);
+    CHECK(RTTTLParser::getFrequency(-1) == 0);
+    
+    // Octave 9 is outside the 108-entry table and plays silent
+    RTTTLNote n[1];
+    CHECK(parseAll("T:d=4,o=5,b=120:c9", n, 1) == 1);
+    CHECK(n[0].index == 108);
+    CHECK(RTTTLParser::getFrequency(n[0].index) == 0);
+}
+
+int main() {
+    testHeaderDefaults();
+    testNoteSyntax();
+    testMalformedInput();
+    testFrequencies();
+    
+    printf("%s: %s\n", __FILE__, failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,300 @@
+/**
+ * Host tests for RTTTLPlayer queueing and RTTTLPlaylist
+ *
+ * Runs the real player against a simulated millis() clock and records every
+ * ledcWriteTone() call, so track order and note timing can be checked to the
+ * millisecond. Run with "make test".
+ */
+#include <RTTTLPlaylist.h>
+
+#include <cstdio>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+// ============================================================================
+// ARDUINO STUBS
+// ============================================================================
+
+struct Tone {
+    unsigned long time;
+    uint32_t freq;
+};
+
+static unsigned long now = 0;
+static std::vector<Tone> tones;
+
+HardwareSerialStub Serial;
+
+unsigned long millis() { return now; }
+long random(long max) { return rand() % max; }
+void ledcAttach(uint8_t, uint32_t, uint8_t) {}
+void ledcWrite(uint8_t, uint32_t) {}
+void ledcWriteTone(uint8_t, uint32_t freq) { tones.push_back(Tone{now, freq}); }
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+// One quarter note each at b=120 (500ms); the pitch identifies the track
+static const char* const TRACKS[] = {
+    "T0:d=4,o=5,b=120:c",
+    "T1:d=4,o=5,b=120:d",
+    "T2:d=4,o=5,b=120:e",
+    "T3:d=4,o=5,b=120:f",
+    "T4:d=4,o=5,b=120:g",
+};
+static const int TRACK_COUNT = 5;
+
+static int trackForFrequency(uint32_t freq) {
+    for (int i = 0; i < TRACK_COUNT; i++) {
+        RTTTLParser parser;
+        RTTTLNote note;
+        parser.begin(TRACKS[i]);
+        parser.next(note);
+        if (static_cast<uint32_t>(RTTTLParser::getFrequency(note.index) + 0.5f) == freq) return i;
+    }
+    return -1;
+}
+
+/// @brief Run the playlist for a time and return tracks in the order they sounded
+static std::vector<int> runPlaylist(RTTTLPlaylist& playlist, unsigned long ms) {
+    tones.clear();
+    for (unsigned long end = now + ms; now < end; now++) playlist.loop();
+    
+    std::vector<int> played;
+    for (const Tone& t : tones) {
+        if (t.freq) played.push_back(trackForFrequency(t.freq));
+    }
+    return played;
+}
+
+static bool isPermutation(const std::vector<int>& seq, size_t first) {
+    bool seen[TRACK_COUNT] = {};
+    for (size_t i = first; i < first + TRACK_COUNT; i++) {
+        if (i >= seq.size() || seq[i] < 0 || seen[seq[i]]) return false;
+        seen[seq[i]] = true;
+    }
+    return true;
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+static void testGaplessQueue(RTTTLPlayer& player) {
+    // c then d, 500ms each, then the queued e must start at exactly +1000ms
+    now = 1000;
+    CHECK(player.play("A:d=4,o=5,b=120:c,d"));
+    tones.clear();                   // drop the silence from play()'s stop()
+    CHECK(player.queueNext("B:d=4,o=5,b=120:e"));
+    CHECK(player.hasQueued());
+    while (player.isPlaying()) {
+        player.loop();
+        now++;
+    }
+    
+    CHECK(tones.size() == 4);
+    CHECK(tones[0].time == 1000 && tones[0].freq == 523);
+    CHECK(tones[1].time == 1500 && tones[1].freq == 587);
+    CHECK(tones[2].time == 2000 && tones[2].freq == 659);
+    CHECK(tones[3].time == 2500 && tones[3].freq == 0);
+    CHECK(!player.hasQueued());
+}
+
+static void testInvalidQueueKeepsStaged(RTTTLPlayer& player) {
+    // A rejected queueNext() must not drop the tune already staged
+    now = 5000;
+    player.play("A:d=4,o=5,b=120:c");
+    tones.clear();
+    CHECK(player.queueNext("B:d=4,o=5,b=120:e"));
+    CHECK(!player.queueNext("junk"));
+    CHECK(player.hasQueued());
+    while (player.isPlaying()) {
+        player.loop();
+        now++;
+    }
+    
+    CHECK(tones.size() == 3);
+    CHECK(tones[1].time == 5500 && tones[1].freq == 659);
+}
+
+static void testQueueResetsTempo(RTTTLPlayer& player) {
+    // Double speed on the first tune must not carry over to the queued one
+    now = 10000;
+    player.play("A:d=4,o=5,b=120:c,d");
+    tones.clear();
+    player.setTempoScale(2.0f);
+    player.queueNext("B:d=4,o=5,b=120:e");
+    while (player.isPlaying()) {
+        player.loop();
+        now++;
+    }
+    
+    CHECK(tones.size() == 4);
+    CHECK(tones[1].time == 10250);   // d at double speed
+    CHECK(tones[2].time == 10500);   // e starts without a gap...
+    CHECK(tones[3].time == 11000);   // ...and plays at normal speed
+}
+
+static void testRepeatOff(RTTTLPlayer& player) {
+    RTTTLPlaylist playlist(player);
+    playlist.add(TRACKS[0]);
+    playlist.add("junk");            // invalid header is skipped
+    playlist.add(TRACKS[2]);
+    playlist.add(TRACKS[3]);
+    
+    CHECK(playlist.play());
+    std::vector<int> played = runPlaylist(playlist, 5000);
+    CHECK((played == std::vector<int>{0, 2, 3}));
+    CHECK(!playlist.isPlaying());
+    CHECK(playlist.getCurrentTrack() == -1);
+}
+
+static void testRepeatOne(RTTTLPlayer& player) {
+    RTTTLPlaylist playlist(player);
+    for (int i = 0; i < TRACK_COUNT; i++) playlist.add(TRACKS[i]);
+    
+    playlist.play();
+    playlist.setRepeat(RTTTLPlaylist::REPEAT_ONE);
+    std::vector<int> played = runPlaylist(playlist, 2500);
+    CHECK((played == std::vector<int>{0, 0, 0, 0, 0}));
+    CHECK(playlist.getCurrentTrack() == 0);
+    
+    // Skipping still moves on
+    CHECK(playlist.next());
+    CHECK(playlist.getCurrentTrack() == 1);
+    playlist.stop();
+}
+
+static void testRepeatAll(RTTTLPlayer& player) {
+    RTTTLPlaylist playlist(player);
+    for (int i = 0; i < TRACK_COUNT; i++) playlist.add(TRACKS[i]);
+    playlist.setRepeat(RTTTLPlaylist::REPEAT_ALL);
+    
+    playlist.play();
+    std::vector<int> played = runPlaylist(playlist, 5000);
+    CHECK((played == std::vector<int>{0, 1, 2, 3, 4, 0, 1, 2, 3, 4}));
+    playlist.stop();
+}
+
+static void testRepeatAllToOff(RTTTLPlayer& player) {
+    RTTTLPlaylist playlist(player);
+    for (int i = 0; i < 3; i++) playlist.add(TRACKS[i]);
+    playlist.setRepeat(RTTTLPlaylist::REPEAT_ALL);
+    
+    // Switched off mid-pass: the rest of the pass plays, then it ends
+    playlist.play();
+    runPlaylist(playlist, 750);
+    playlist.setRepeat(RTTTLPlaylist::REPEAT_OFF);
+    std::vector<int> played = runPlaylist(playlist, 3000);
+    CHECK((played == std::vector<int>{2}));
+    CHECK(!playlist.isPlaying());
+    
+    // Switched off during the last track: ends after it, no extra pass
+    playlist.setRepeat(RTTTLPlaylist::REPEAT_ALL);
+    playlist.play();
+    runPlaylist(playlist, 1250);
+    CHECK(playlist.getCurrentTrack() == 2);
+    playlist.setRepeat(RTTTLPlaylist::REPEAT_OFF);
+    played = runPlaylist(playlist, 3000);
+    CHECK(played.empty());
+    CHECK(!playlist.isPlaying());
+}
+
+static void testShuffleToggleAtLastTrack(RTTTLPlayer& player) {
+    RTTTLPlaylist playlist(player);
+    for (int i = 0; i < TRACK_COUNT; i++) playlist.add(TRACKS[i]);
+    playlist.setRepeat(RTTTLPlaylist::REPEAT_ALL);
+    playlist.setShuffle(true);
+    
+    // Shuffle off during the last track of a pass: the next pass is sequential
+    srand(3);
+    playlist.play();
+    std::vector<int> played = runPlaylist(playlist, 4 * 500 + 250);
+    CHECK(played.size() == 5 && isPermutation(played, 0));
+    playlist.setShuffle(false);
+    played = runPlaylist(playlist, 5 * 500);
+    CHECK((played == std::vector<int>{0, 1, 2, 3, 4}));
+    
+    // Shuffle on during the last track: the next pass is a fresh full
+    // permutation that doesn't reopen with track 4
+    runPlaylist(playlist, 250);
+    CHECK(playlist.getCurrentTrack() == 4);
+    playlist.setShuffle(true);
+    played = runPlaylist(playlist, 5 * 500);
+    CHECK(isPermutation(played, 0));
+    CHECK(played.size() == 5 && played[0] != 4);
+    playlist.stop();
+}
+
+static void testShufflePasses(RTTTLPlayer& player) {
+    RTTTLPlaylist playlist(player);
+    for (int i = 0; i < TRACK_COUNT; i++) playlist.add(TRACKS[i]);
+    playlist.setRepeat(RTTTLPlaylist::REPEAT_ALL);
+    playlist.setShuffle(true);
+    
+    // Every pass plays every track once, never the same track twice in a row
+    srand(1);
+    playlist.play();
+    std::vector<int> played = runPlaylist(playlist, 20 * 500);
+    CHECK(played.size() == 20);
+    for (size_t pass = 0; pass < 4; pass++) CHECK(isPermutation(played, pass * TRACK_COUNT));
+    for (size_t i = 1; i < played.size(); i++) CHECK(played[i] != played[i - 1]);
+    
+    // Turning shuffle off takes effect from the next pass. Two tracks into
+    // the fifth pass, the rest of it plays, then the order is sequential.
+    played = runPlaylist(playlist, 2 * 500);
+    playlist.setShuffle(false);
+    played = runPlaylist(playlist, 3 * 500 + 5 * 500);
+    CHECK(played.size() == 8);
+    CHECK((std::vector<int>(played.begin() + 3, played.end()) == std::vector<int>{0, 1, 2, 3, 4}));
+    playlist.stop();
+}
+
+static void testShuffleSkip(RTTTLPlayer& player) {
+    RTTTLPlaylist playlist(player);
+    for (int i = 0; i < TRACK_COUNT; i++) playlist.add(TRACKS[i]);
+    playlist.setRepeat(RTTTLPlaylist::REPEAT_ALL);
+    playlist.setShuffle(true);
+    
+    // Wrapping with next() starts a fresh full pass too
+    srand(2);
+    playlist.play();
+    std::vector<int> played{playlist.getCurrentTrack()};
+    for (int i = 0; i < 3 * TRACK_COUNT - 1; i++) {
+        CHECK(playlist.next());
+        played.push_back(playlist.getCurrentTrack());
+    }
+    for (size_t pass = 0; pass < 3; pass++) CHECK(isPermutation(played, pass * TRACK_COUNT));
+    for (size_t i = 1; i < played.size(); i++) CHECK(played[i] != played[i - 1]);
+    playlist.stop();
+}
+
+int main() {
+    RTTTLPlayer player(3, 180);
+    player.begin();
+    player.setDebug(false);
+    
+    testGaplessQueue(player);
+    testInvalidQueueKeepsStaged(player);
+    testQueueResetsTempo(player);
+    testRepeatOff(player);
+    testRepeatOne(player);
+    testRepeatAll(player);
+    testRepeatAllToOff(player);
+    testShuffleToggleAtLastTrack(player);
+    testShufflePasses(player);
+    testShuffleSkip(player);
+    
+    printf("%s: %s\n", __FILE__, failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}